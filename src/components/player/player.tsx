@@ -38,8 +38,13 @@ const VST_PARAM = {
   MUTE_BASS: 110,
   MUTE_DRUMS: 111,
   ONLY_BASS_DRUMS: 112,
+  SC_DENSITY_MOD: 116,
+  SC_BRIGHTNESS_MOD: 117,
 } as const;
 
+// Minimum spacing between config updates driven by sidechain modulation
+const SIDECHAIN_CONFIG_INTERVAL_MS = 250;
+
 export default function Player() {
   const { apiKey, isLoading: settingsLoading } = useSettings();
 
@@ -103,6 +108,21 @@ export default function Player() {
   const lastScaleRef = useRef(cfg.scale);
   const layersRef = useRef(layers);
   const cfgRef = useRef(cfg);
+
+  // Sidechain offsets from the VST (-1..+1); applied on top of cfg, never stored in it
+  const sidechainModRef = useRef({ density: 0, brightness: 0 });
+  const sidechainTimerRef = useRef<ReturnType<typeof setTimeout> | null>(null);
+
+  const withSidechain = useCallback((c: GlobalConfig): GlobalConfig => {
+    const mod = sidechainModRef.current;
+    if (!mod.density && !mod.brightness) return c;
+    const clamp01 = (v: number) => Math.max(0, Math.min(1, v));
+    return {
+      ...c,
+      density: clamp01(c.density + mod.density),
+      brightness: clamp01(c.brightness + mod.brightness),
+    };
+  }, []);
   const lastApiKeyRef = useRef<string | null>(null);
 
   const audioSession = useAudioSession();
@@ -273,7 +293,7 @@ export default function Player() {
       setFilteredNotice(null);
 
       await sendWeightedPrompts(layers);
-      await sendConfig(cfg);
+      await sendConfig(withSidechain(cfg));
 
       sessionPlay();
       audioSession.fadeTo(volume / 100, 120);
@@ -323,7 +343,7 @@ export default function Player() {
     if (!sessionRef.current) return;
     if (playback !== 'playing') return;
     const id = setTimeout(async () => {
-      const result = await sendConfig(cfg, {
+      const result = await sendConfig(withSidechain(cfg), {
         maybeResetForDrastic: true,
         lastBpm: lastBpmRef.current,
         lastScale: lastScaleRef.current,
@@ -338,6 +358,7 @@ export default function Player() {
     sessionRef,
     playback,
     sendConfig,
+    withSidechain,
   ]);
 
   useEffect(() => {
@@ -424,6 +445,21 @@ export default function Player() {
     }
   };
 
+  const scheduleSidechainConfig = useCallback(() => {
+    if (sidechainTimerRef.current) return;
+    sidechainTimerRef.current = setTimeout(() => {
+      sidechainTimerRef.current = null;
+      if (!sessionRef.current) return;
+      void sendConfig(withSidechain(cfgRef.current));
+    }, SIDECHAIN_CONFIG_INTERVAL_MS);
+  }, [sessionRef, sendConfig, withSidechain]);
+
+  useEffect(() => {
+    return () => {
+      if (sidechainTimerRef.current) clearTimeout(sidechainTimerRef.current);
+    };
+  }, []);
+
   useVSTSync(
     useCallback((paramId: number, normalizedValue: number) => {
       switch (paramId) {
@@ -457,8 +493,16 @@ export default function Player() {
         case VST_PARAM.ONLY_BASS_DRUMS:
           setCfg((c) => ({ ...c, onlyBassAndDrums: normalizedValue > 0.5 }));
           break;
+        case VST_PARAM.SC_DENSITY_MOD:
+          sidechainModRef.current.density = normalizedValue * 2 - 1;
+          scheduleSidechainConfig();
+          break;
+        case VST_PARAM.SC_BRIGHTNESS_MOD:
+          sidechainModRef.current.brightness = normalizedValue * 2 - 1;
+          scheduleSidechainConfig();
+          break;
       }
-    }, [])
+    }, [scheduleSidechainConfig])
   );
 
   return (
@@ -0,0 +1,345 @@
+// Scaling harness for the out-of-process generator host (Linux).
+//
+// For each instance count: forks UnderlayGeneratorHost with the synthetic
+// source, opens N GeneratorHostClients, reads 256-frame blocks at real-time
+// pace and reports OPEN latency, ring fill (buffered latency), underruns and
+// resident memory on both sides. It then stops the host (SIGSTOP) while the
+// clients keep reading and reports how much audio was still buffered when each
+// one fell back, and finally SIGKILLs the host and times the fallback.
+//
+// Two cleanup cases follow: a session that is opened and closed without
+// mapping its ring, and a host killed before its client mapped the ring (the
+// next host must remove it). Both check /dev/shm directly.
+//
+// Usage: GeneratorHostHarness [--host PATH] [--instances 1,4,16,64] [--seconds S]
+
+#include "GeneratorHostClient.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <signal.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace Underlay;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const int kSampleRate = 48000;
+const int kBlockSize = 256;
+
+// Resident set size in kB from /proc, -1 if unavailable
+long residentKb(const std::string& pid) {
+    std::ifstream status("/proc/" + pid + "/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) return std::atol(line.c_str() + 6);
+    }
+    return -1;
+}
+
+double framesToMs(double frames) {
+    return frames * 1000.0 / kSampleRate;
+}
+
+// Whether a shm name (with leading slash) still exists
+bool segmentExists(const std::string& shmName) {
+    return access(("/dev/shm" + shmName).c_str(), F_OK) == 0;
+}
+
+pid_t startHost(const std::string& hostPath, const std::string& socketPath) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        execl(hostPath.c_str(), hostPath.c_str(), "--socket", socketPath.c_str(), "--synthetic", (char*)nullptr);
+        std::perror("execl");
+        _exit(127);
+    }
+    return pid;
+}
+
+void stopHost(pid_t hostPid) {
+    kill(hostPid, SIGKILL);
+    waitpid(hostPid, nullptr, 0);
+}
+
+// Wait for the listener by opening (and dropping) a session
+bool waitForHost(const std::string& socketPath) {
+    GeneratorHostClient probe;
+    for (int attempt = 0; attempt < 200; ++attempt) {
+        if (probe.connect(socketPath, kSampleRate)) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::fprintf(stderr, "Host did not start\n");
+    return false;
+}
+
+// Bare protocol client: sends OPEN and returns the socket, leaving the ring
+// unmapped. Returns -1 on failure.
+int openRawSession(const std::string& socketPath, std::string& shmName) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    std::string request = "OPEN " + std::to_string(kSampleRate) + "\n";
+    std::string reply;
+    char c;
+    if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size()) {
+        close(fd);
+        return -1;
+    }
+    while (reply.size() < 512 && recv(fd, &c, 1, 0) == 1 && c != '\n') reply.push_back(c);
+
+    std::istringstream parser(reply);
+    std::string status;
+    int sessionId;
+    parser >> status >> sessionId >> shmName;
+    if (status != "OK" || parser.fail()) {
+        std::fprintf(stderr, "OPEN rejected: %s\n", reply.c_str());
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Poll until the segment is gone or the timeout passes
+bool waitForUnlink(const std::string& shmName, int timeoutMs) {
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (segmentExists(shmName)) {
+        if (Clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+bool runScale(const std::string& hostPath, const std::string& socketPath, int instances, double seconds) {
+    pid_t hostPid = startHost(hostPath, socketPath);
+    if (hostPid < 0) return false;
+    if (!waitForHost(socketPath)) {
+        stopHost(hostPid);
+        return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    long hostBaseKb = residentKb(std::to_string(hostPid));
+    long clientBaseKb = residentKb("self");
+
+    std::vector<std::unique_ptr<GeneratorHostClient>> clients;
+    double openMs = 0.0;
+    for (int i = 0; i < instances; ++i) {
+        auto client = std::make_unique<GeneratorHostClient>();
+        auto start = Clock::now();
+        if (!client->connect(socketPath, kSampleRate)) {
+            std::fprintf(stderr, "OPEN failed for instance %d\n", i);
+            break;
+        }
+        openMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        clients.push_back(std::move(client));
+    }
+    bool ok = (int)clients.size() == instances;
+
+    // Let the host fill every ring before measuring
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::vector<float> left(kBlockSize), right(kBlockSize);
+    float* outputs[2] = {left.data(), right.data()};
+    auto period = std::chrono::microseconds(kBlockSize * 1000000LL / kSampleRate);
+    int blocks = (int)(seconds * kSampleRate / kBlockSize);
+    long reads = 0, underruns = 0;
+    double fillFrames = 0.0;
+
+    auto next = Clock::now();
+    for (int b = 0; b < blocks && ok; ++b) {
+        for (auto& client : clients) {
+            fillFrames += client->ring()->available();
+            if (client->ring()->read(outputs, 2, kBlockSize) < (size_t)kBlockSize) ++underruns;
+            ++reads;
+        }
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+
+    long hostKb = residentKb(std::to_string(hostPid));
+    long clientKb = residentKb("self");
+
+    // Hung host: keep reading like process() does until each client falls
+    // back; the ring must never run dry before that
+    kill(hostPid, SIGSTOP);
+    std::vector<bool> fellBack(clients.size(), false);
+    size_t stalledCount = 0;
+    double minLeftFrames = 1e9;
+    long stallUnderruns = 0;
+    auto stallStart = Clock::now();
+    next = stallStart;
+    while (ok && stalledCount < clients.size() && Clock::now() - stallStart < std::chrono::seconds(2)) {
+        for (size_t i = 0; i < clients.size(); ++i) {
+            if (fellBack[i]) continue;
+            if (!clients[i]->isHealthy()) {
+                fellBack[i] = true;
+                ++stalledCount;
+                minLeftFrames = std::min(minLeftFrames, (double)clients[i]->ring()->available());
+                continue;
+            }
+            if (clients[i]->ring()->read(outputs, 2, kBlockSize) < (size_t)kBlockSize) ++stallUnderruns;
+        }
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    bool stallOk = stalledCount == clients.size() && stallUnderruns == 0;
+    kill(hostPid, SIGCONT);
+
+    // Restart the clients, then simulate a host crash: every client must fall back
+    for (auto& client : clients) {
+        if (!client->connect(socketPath, kSampleRate)) ok = false;
+    }
+    auto crashTime = Clock::now();
+    kill(hostPid, SIGKILL);
+    waitpid(hostPid, nullptr, 0);
+    bool allFellBack = false;
+    while (ok && !allFellBack && Clock::now() - crashTime < std::chrono::seconds(2)) {
+        allFellBack = true;
+        for (auto& client : clients) allFellBack = allFellBack && !client->isHealthy();
+        if (!allFellBack) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double fallbackMs = std::chrono::duration<double, std::milli>(Clock::now() - crashTime).count();
+    clients.clear();
+
+    std::printf("%9d  %8.3f ms  %8.1f ms  %5ld/%-7ld  %7ld kB  %9.1f kB  %7ld kB  %9.1f kB  %8.1f ms  %8.1f ms\n",
+                instances, instances ? openMs / instances : 0.0,
+                reads ? framesToMs(fillFrames / reads) : 0.0,
+                underruns, reads,
+                hostKb, instances ? (hostKb - hostBaseKb) / (double)instances : 0.0,
+                clientKb, instances ? (clientKb - clientBaseKb) / (double)instances : 0.0,
+                stallOk ? framesToMs(minLeftFrames) : -1.0,
+                allFellBack ? fallbackMs : -1.0);
+
+    return ok && stallOk && allFellBack && underruns == 0;
+}
+
+// Session opened and closed without the client ever mapping the ring
+bool runUnmappedClose(const std::string& hostPath, const std::string& socketPath) {
+    pid_t hostPid = startHost(hostPath, socketPath);
+    if (hostPid < 0 || !waitForHost(socketPath)) {
+        if (hostPid > 0) stopHost(hostPid);
+        return false;
+    }
+
+    std::string shmName;
+    int fd = openRawSession(socketPath, shmName);
+    bool created = fd >= 0 && segmentExists(shmName);
+    if (fd >= 0) close(fd);
+    bool removed = created && waitForUnlink(shmName, 1000);
+    stopHost(hostPid);
+
+    std::printf("unmapped session closed:     segment %s\n",
+                !created ? "not created" : removed ? "removed by host" : "LEAKED");
+    return removed;
+}
+
+// Host killed after OPEN but before the client mapped the ring
+bool runKilledBeforeMap(const std::string& hostPath, const std::string& socketPath) {
+    pid_t hostPid = startHost(hostPath, socketPath);
+    if (hostPid < 0 || !waitForHost(socketPath)) {
+        if (hostPid > 0) stopHost(hostPid);
+        return false;
+    }
+
+    std::string shmName;
+    int fd = openRawSession(socketPath, shmName);
+    stopHost(hostPid);
+    if (fd >= 0) close(fd);
+    bool orphaned = fd >= 0 && segmentExists(shmName);
+
+    // The next host sweeps segments of dead hosts on start
+    bool removed = false;
+    if (orphaned) {
+        pid_t nextPid = startHost(hostPath, socketPath);
+        if (nextPid > 0) {
+            removed = waitForHost(socketPath) && waitForUnlink(shmName, 1000);
+            stopHost(nextPid);
+        }
+    }
+
+    std::printf("host killed before mapping:  segment %s\n",
+                !orphaned ? "not orphaned (unexpected)" : removed ? "removed by next host" : "LEAKED");
+    return removed;
+}
+
+std::vector<int> parseCounts(const std::string& list) {
+    std::vector<int> counts;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int n = std::atoi(item.c_str());
+        if (n > 0) counts.push_back(n);
+    }
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string self = argv[0];
+    size_t slash = self.rfind('/');
+    std::string hostPath = (slash == std::string::npos ? std::string(".") : self.substr(0, slash)) + "/UnderlayGeneratorHost";
+    std::vector<int> counts = {1, 4, 16, 64};
+    double seconds = 2.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--host" && i + 1 < argc) {
+            hostPath = argv[++i];
+        } else if (arg == "--instances" && i + 1 < argc) {
+            counts = parseCounts(argv[++i]);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: %s [--host PATH] [--instances 1,4,16,64] [--seconds S]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    char dirTemplate[] = "/tmp/underlay-harness-XXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    std::string socketPath = std::string(dirTemplate) + "/host.sock";
+
+    std::printf("# %d Hz, %d-frame blocks, %.1f s per run; client RSS excludes the plugin's WebView\n",
+                kSampleRate, kBlockSize, seconds);
+    std::printf("# stall left = least audio still buffered when a client fell back from a stopped host\n");
+    std::printf("%9s  %11s  %11s  %13s  %10s  %12s  %10s  %12s  %11s  %11s\n",
+                "instances", "OPEN", "buffered", "underruns", "host RSS", "host/inst",
+                "client RSS", "client/inst", "stall left", "crash");
+
+    bool ok = true;
+    for (int instances : counts) {
+        ok = runScale(hostPath, socketPath, instances, seconds) && ok;
+    }
+
+    std::printf("\n");
+    ok = runUnmappedClose(hostPath, socketPath) && ok;
+    ok = runKilledBeforeMap(hostPath, socketPath) && ok;
+
+    unlink(socketPath.c_str());
+    rmdir(dirTemplate);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// Per-block cost of the sidechain path (Linux/macOS, no VST3 SDK needed).
+//
+// Mirrors UnderlayProcessor::processSidechain(): depth lookups in a parameter
+// map like the processor's, SidechainModulator::process(), and a sink that
+// appends points to a fixed-size queue set the way IParameterChanges does.
+//
+// Usage: SidechainBenchmark [iterations]
+
+#include "SidechainModulator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace Underlay;
+
+namespace {
+
+const double kSampleRate = 48000.0;
+
+// Mirrors PluginIDs.h, which needs the SDK headers
+enum : unsigned {
+    kParamBPM = 100,
+    kParamPlayPause = 113,
+    kParamSidechainDensityDepth = 114,
+    kParamSidechainBrightnessDepth = 115,
+    kParamSidechainDensityMod = 116,
+    kParamSidechainBrightnessMod = 117,
+};
+
+// Stand-in for the host's output IParameterChanges: linear search by id, append a point
+struct OutputChanges {
+    struct Queue {
+        unsigned id;
+        int numPoints;
+        double values[16];
+    };
+
+    Queue queues[8];
+    int numQueues = 0;
+
+    void clear() { numQueues = 0; }
+
+    Queue* addParameterData(unsigned id) {
+        for (int i = 0; i < numQueues; ++i) {
+            if (queues[i].id == id) return &queues[i];
+        }
+        if (numQueues == 8) return nullptr;
+        Queue* queue = &queues[numQueues++];
+        queue->id = id;
+        queue->numPoints = 0;
+        return queue;
+    }
+};
+
+// Noise bursts alternating loud/quiet every 100 ms so the follower keeps moving
+std::vector<float> makeSidechainSignal(size_t length) {
+    std::vector<float> signal(length);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    for (size_t i = 0; i < length; ++i) {
+        float gain = ((i / 4800) % 2 == 0) ? 0.8f : 0.01f;
+        signal[i] = gain * noise(rng);
+    }
+    return signal;
+}
+
+double getParameter(const std::map<unsigned, double>& parameters, unsigned id, double defaultValue) {
+    auto it = parameters.find(id);
+    return it != parameters.end() ? it->second : defaultValue;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+    if (iterations <= 0) iterations = 200000;
+
+    std::vector<float> signal = makeSidechainSignal((size_t)kSampleRate * 2);
+
+    // Same kind of map the processor fills from automation
+    std::map<unsigned, double> parameters;
+    for (unsigned id = kParamBPM; id <= kParamPlayPause; ++id) parameters[id] = 0.5;
+    parameters[kParamSidechainDensityDepth] = 1.0;
+    parameters[kParamSidechainBrightnessDepth] = 0.0;
+
+    std::printf("# %.0f Hz stereo sidechain, %d blocks per size\n", kSampleRate, iterations);
+    std::printf("%5s  %12s  %14s  %14s\n", "block", "us/block", "changes/block", "changes/sec");
+
+    for (int blockSize : {64, 256, 512}) {
+        SidechainModulator modulator;
+        modulator.prepare(kSampleRate);
+        OutputChanges outputs;
+
+        const float* channels[2] = {nullptr, nullptr};
+        size_t pos = 0;
+        long changes = 0;
+        double totalSeconds = 0.0;
+
+        for (int i = 0; i < iterations; ++i) {
+            if (pos + blockSize > signal.size()) pos = 0;
+            channels[0] = signal.data() + pos;
+            channels[1] = channels[0];
+            pos += blockSize;
+            outputs.clear();
+
+            auto start = std::chrono::steady_clock::now();
+
+            double densityDepth = getParameter(parameters, kParamSidechainDensityDepth, 0.5) * 2.0 - 1.0;
+            double brightnessDepth = getParameter(parameters, kParamSidechainBrightnessDepth, 0.5) * 2.0 - 1.0;
+            modulator.process(channels, 2, blockSize, densityDepth, brightnessDepth,
+                              [&outputs](SidechainModulator::Target target, double offset) {
+                                  unsigned id = (target == SidechainModulator::kDensity)
+                                                    ? kParamSidechainDensityMod
+                                                    : kParamSidechainBrightnessMod;
+                                  if (auto* queue = outputs.addParameterData(id)) {
+                                      queue->values[queue->numPoints++ & 15] =
+                                          SidechainModulator::toNormalized(offset);
+                                  }
+                              });
+
+            auto end = std::chrono::steady_clock::now();
+            totalSeconds += std::chrono::duration<double>(end - start).count();
+            changes += outputs.numQueues;
+        }
+
+        double changesPerBlock = (double)changes / iterations;
+        std::printf("%5d  %12.3f  %14.3f  %14.1f\n", blockSize, totalSeconds * 1e6 / iterations,
+                    changesPerBlock, changesPerBlock * kSampleRate / blockSize);
+    }
+    return 0;
+}
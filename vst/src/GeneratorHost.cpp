@@ -0,0 +1,292 @@
+// Out-of-process generator host (experimental transport only).
+//
+// Serves sessions for all plugin instances from one process, each with its own
+// SharedAudioRing; the control plane is described in GeneratorHostProtocol.h.
+// This is the transport for moving generation out of the plugin: sessions
+// render a synthetic tone, and the Lyria session still runs in the plugin's
+// WebView. Hosting that generator here, with prompts and parameters driven
+// over the socket, is still to do, so the plugin only uses this host in builds
+// with UNDERLAY_EXPERIMENTAL_GENERATOR_HOST.
+//
+// Usage: UnderlayGeneratorHost [--socket PATH] [--synthetic]
+
+#include "GeneratorHostProtocol.h"
+#include "SharedAudioRing.h"
+#include "DebugLog.h"
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <vector>
+#if defined(__linux__)
+#include <dirent.h>
+#endif
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace Underlay;
+
+namespace {
+
+volatile std::sig_atomic_t gRunning = 1;
+
+// Ring names are /underlay.<hostPid>.<sessionId>
+const char* const kSegmentPrefix = "underlay.";
+
+void handleSignal(int) {
+    gRunning = 0;
+}
+
+/**
+ * Audio source for one session. Only the synthetic source exists for now;
+ * it renders a per-session tone so sessions can be told apart in tests.
+ */
+class SyntheticSource {
+public:
+    SyntheticSource(int sessionId, int sampleRate)
+        : sampleRate_(sampleRate > 0 ? sampleRate : 48000),
+          frequency_(220.0 * std::pow(2.0, (sessionId % 12) / 12.0)) {}
+
+    void render(float* left, float* right, int numFrames) {
+        const double twoPi = 6.283185307179586;
+        double increment = twoPi * frequency_ / sampleRate_;
+        for (int i = 0; i < numFrames; ++i) {
+            float sample = 0.25f * (float)std::sin(phase_);
+            left[i] = sample;
+            right[i] = sample;
+            phase_ += increment;
+            if (phase_ >= twoPi) phase_ -= twoPi;
+        }
+    }
+
+private:
+    int sampleRate_;
+    double frequency_;
+    double phase_ = 0.0;
+};
+
+struct Session {
+    int id = -1;
+    int fd = -1;
+    std::string input;
+    std::unique_ptr<SharedAudioRing> ring;
+    std::unique_ptr<SyntheticSource> source;
+};
+
+void sendLine(int fd, const std::string& line) {
+    std::string data = line + "\n";
+#ifdef MSG_NOSIGNAL
+    ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+#else
+    ::send(fd, data.data(), data.size(), 0);
+#endif
+}
+
+void handleCommand(Session& session, const std::string& line) {
+    std::istringstream parser(line);
+    std::string command;
+    parser >> command;
+
+    if (command == "OPEN") {
+        int sampleRate = 0;
+        parser >> sampleRate;
+        if (parser.fail() || sampleRate <= 0) {
+            sendLine(session.fd, "ERR bad sample rate");
+            return;
+        }
+        if (session.ring) {
+            sendLine(session.fd, "ERR session already open");
+            return;
+        }
+
+        // Keep names short: macOS limits shm names to 31 characters
+        std::ostringstream name;
+        name << "/" << kSegmentPrefix << getpid() << "." << session.id;
+        session.ring = SharedAudioRing::create(name.str(), GeneratorHostProtocol::kRingCapacityFrames,
+                                               (uint32_t)sampleRate);
+        if (!session.ring) {
+            sendLine(session.fd, "ERR shared memory unavailable");
+            return;
+        }
+        session.source = std::make_unique<SyntheticSource>(session.id, sampleRate);
+
+        std::ostringstream reply;
+        reply << "OK " << session.id << " " << name.str() << " " << session.ring->capacity();
+        sendLine(session.fd, reply.str());
+        DEBUG_LOG("[GeneratorHost] Opened session " << session.id << " at " << sampleRate << " Hz");
+        return;
+    }
+
+    sendLine(session.fd, "ERR unknown command");
+}
+
+// Top up a session's ring to the target fill level
+void renderSession(Session& session) {
+    if (!session.ring) return;
+
+    const int kBlockFrames = 256;
+    float left[kBlockFrames];
+    float right[kBlockFrames];
+
+    while (session.ring->available() < GeneratorHostProtocol::kTargetFillFrames) {
+        session.source->render(left, right, kBlockFrames);
+        if (session.ring->write(left, right, kBlockFrames) < (size_t)kBlockFrames) break;
+    }
+}
+
+// Remove rings left by a host that died between OPEN and the client mapping
+// them (clients unlink once mapped, and a live host unlinks on session close).
+// Only Linux exposes shm names as files, elsewhere this is a no-op.
+void removeStaleSegments() {
+#if defined(__linux__)
+    DIR* dir = ::opendir("/dev/shm");
+    if (!dir) return;
+
+    size_t prefixLength = std::strlen(kSegmentPrefix);
+    while (dirent* entry = ::readdir(dir)) {
+        if (std::strncmp(entry->d_name, kSegmentPrefix, prefixLength) != 0) continue;
+
+        char* end = nullptr;
+        long pid = std::strtol(entry->d_name + prefixLength, &end, 10);
+        if (pid <= 0 || end == entry->d_name + prefixLength || *end != '.') continue;
+        if (pid == getpid() || ::kill((pid_t)pid, 0) == 0 || errno == EPERM) continue;
+
+        std::string name = std::string("/") + entry->d_name;
+        if (shm_unlink(name.c_str()) == 0) {
+            DEBUG_LOG("[GeneratorHost] Removed stale segment " << name);
+        }
+    }
+    ::closedir(dir);
+#endif
+}
+
+int createListener(const std::string& path) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::fprintf(stderr, "Socket path too long: %s\n", path.c_str());
+        return -1;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::perror("socket");
+        return -1;
+    }
+
+    // Remove a stale socket left by a previous host
+    ::unlink(path.c_str());
+
+    // Owner-only from the moment it exists, so other users can't connect
+    mode_t previousMask = ::umask(077);
+    int bound = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::umask(previousMask);
+    if (bound != 0 || ::chmod(path.c_str(), 0600) != 0 || ::listen(fd, 64) != 0) {
+        std::perror("bind/listen");
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string socketPath = GeneratorHostProtocol::socketPath();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--synthetic") {
+            // Synthetic tone source (currently the only source)
+        } else {
+            std::fprintf(stderr, "Usage: %s [--socket PATH] [--synthetic]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    removeStaleSegments();
+
+    int listener = createListener(socketPath);
+    if (listener < 0) return 1;
+    DEBUG_LOG("[GeneratorHost] Listening on " << socketPath);
+
+    std::map<int, Session> sessions;  // keyed by fd
+    int nextSessionId = 0;
+    std::vector<pollfd> fds;
+
+    while (gRunning) {
+        fds.clear();
+        fds.push_back({listener, POLLIN, 0});
+        for (auto& entry : sessions) {
+            fds.push_back({entry.first, POLLIN, 0});
+        }
+
+        // Short timeout so rings are topped up at least every 2 ms
+        int ready = ::poll(fds.data(), fds.size(), 2);
+        if (ready < 0 && errno != EINTR) {
+            std::perror("poll");
+            break;
+        }
+
+        if (ready > 0) {
+            if (fds[0].revents & POLLIN) {
+                int client = ::accept(listener, nullptr, nullptr);
+                if (client >= 0) {
+                    Session& session = sessions[client];
+                    session.id = nextSessionId++;
+                    session.fd = client;
+                }
+            }
+
+            for (size_t i = 1; i < fds.size(); ++i) {
+                if (!fds[i].revents) continue;
+
+                auto it = sessions.find(fds[i].fd);
+                char buffer[512];
+                ssize_t n = ::recv(fds[i].fd, buffer, sizeof(buffer), 0);
+                if (n <= 0) {
+                    // Plugin instance went away: drop its session and ring
+                    DEBUG_LOG("[GeneratorHost] Closed session " << it->second.id);
+                    ::close(fds[i].fd);
+                    sessions.erase(it);
+                    continue;
+                }
+
+                Session& session = it->second;
+                session.input.append(buffer, (size_t)n);
+                size_t newline;
+                while ((newline = session.input.find('\n')) != std::string::npos) {
+                    handleCommand(session, session.input.substr(0, newline));
+                    session.input.erase(0, newline + 1);
+                }
+                if (session.input.size() > 4096) session.input.clear();
+            }
+        }
+
+        for (auto& entry : sessions) {
+            renderSession(entry.second);
+        }
+    }
+
+    for (auto& entry : sessions) {
+        ::close(entry.first);
+    }
+    sessions.clear();
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+    return 0;
+}
@@ -0,0 +1,260 @@
+#include "GeneratorHostClient.h"
+#include "GeneratorHostProtocol.h"
+#include "DebugLog.h"
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Underlay {
+
+/**
+ * One thread per process that watches every connected client, so instance
+ * count doesn't multiply threads. Starts with the first client and stops with
+ * the last, so nothing is left running when the plugin is unloaded.
+ */
+class GeneratorHostWatchdog {
+public:
+    static GeneratorHostWatchdog& getInstance() {
+        static GeneratorHostWatchdog instance;
+        return instance;
+    }
+
+    void add(GeneratorHostClient* client) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clients_.push_back({client, nextSerial_++});
+        if (!thread_.joinable()) {
+            uint64_t generation = ++generation_;
+            thread_ = std::thread(&GeneratorHostWatchdog::run, this, generation);
+        }
+    }
+
+    // Returns once the watchdog no longer touches the client
+    void remove(GeneratorHostClient* client) {
+        std::thread finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto it = clients_.begin(); it != clients_.end(); ++it) {
+                if (it->client == client) {
+                    clients_.erase(it);
+                    break;
+                }
+            }
+            if (clients_.empty() && thread_.joinable()) {
+                ++generation_;
+                finished = std::move(thread_);
+            }
+        }
+        if (finished.joinable()) finished.join();
+    }
+
+private:
+    struct Entry {
+        GeneratorHostClient* client;
+        uint64_t serial;
+    };
+
+    static const int kPollIntervalMs = 10;
+
+    GeneratorHostWatchdog() = default;
+
+    void run(uint64_t generation) {
+        std::vector<Entry> watched;
+        std::vector<pollfd> fds;
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (generation == generation_) {
+            watched = clients_;
+            fds.clear();
+            for (const Entry& entry : watched) {
+                fds.push_back({entry.client->socket_, POLLIN, 0});
+            }
+
+            // Poll unlocked so connect/disconnect never wait on it; doubles as the sleep
+            lock.unlock();
+            ::poll(fds.data(), fds.size(), kPollIntervalMs);
+            lock.lock();
+
+            // Skip clients that went away (or were replaced) while polling
+            size_t next = 0;
+            for (size_t i = 0; i < watched.size(); ++i) {
+                while (next < clients_.size() && clients_[next].serial < watched[i].serial) ++next;
+                if (next < clients_.size() && clients_[next].serial == watched[i].serial) {
+                    clients_[next].client->checkHealth(fds[i].revents);
+                }
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::vector<Entry> clients_;  // ordered by serial
+    uint64_t nextSerial_ = 0;
+    uint64_t generation_ = 0;
+    std::thread thread_;
+};
+
+GeneratorHostClient::~GeneratorHostClient() {
+    disconnect();
+}
+
+bool GeneratorHostClient::connect(const std::string& socketPath, int sampleRate) {
+    disconnect();
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        DEBUG_LOG("[GeneratorHostClient] Socket path too long: " << socketPath);
+        return false;
+    }
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    socket_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_ < 0) {
+        DEBUG_LOG("[GeneratorHostClient] socket() failed: " << strerror(errno));
+        return false;
+    }
+
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(socket_, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    // Don't let a stalled host block plugin activation
+    timeval timeout = {1, 0};
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(socket_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    if (::connect(socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        DEBUG_LOG("[GeneratorHostClient] No generator host at " << socketPath << ": " << strerror(errno));
+        disconnect();
+        return false;
+    }
+
+    if (!isPeerSameUser()) {
+        DEBUG_LOG("[GeneratorHostClient] Generator host at " << socketPath << " belongs to another user");
+        disconnect();
+        return false;
+    }
+
+    std::ostringstream request;
+    request << "OPEN " << sampleRate << "\n";
+    std::string requestStr = request.str();
+#ifdef MSG_NOSIGNAL
+    int flags = MSG_NOSIGNAL;
+#else
+    int flags = 0;
+#endif
+    if (::send(socket_, requestStr.data(), requestStr.size(), flags) != (ssize_t)requestStr.size()) {
+        DEBUG_LOG("[GeneratorHostClient] Failed to send OPEN: " << strerror(errno));
+        disconnect();
+        return false;
+    }
+
+    std::string reply;
+    if (!readLine(reply)) {
+        DEBUG_LOG("[GeneratorHostClient] No reply to OPEN");
+        disconnect();
+        return false;
+    }
+
+    std::istringstream parser(reply);
+    std::string status, shmName;
+    unsigned capacity = 0;
+    parser >> status >> sessionId_ >> shmName >> capacity;
+    if (status != "OK" || parser.fail()) {
+        DEBUG_LOG("[GeneratorHostClient] OPEN rejected: " << reply);
+        disconnect();
+        return false;
+    }
+
+    ring_ = SharedAudioRing::open(shmName);
+    if (!ring_) {
+        disconnect();
+        return false;
+    }
+
+    // The mapping keeps the segment alive; unlinking now means nothing is
+    // left in shared memory if the host dies
+    shm_unlink(shmName.c_str());
+
+    lastWritePos_ = ring_->writePosition();
+    readPosAtLastWrite_ = ring_->readPosition();
+    healthy_.store(true, std::memory_order_release);
+    GeneratorHostWatchdog::getInstance().add(this);
+
+    DEBUG_LOG("[GeneratorHostClient] Session " << sessionId_ << " on " << shmName
+              << " (" << ring_->capacity() << " frames)");
+    return true;
+}
+
+void GeneratorHostClient::disconnect() {
+    if (ring_) {
+        GeneratorHostWatchdog::getInstance().remove(this);
+    }
+    healthy_.store(false, std::memory_order_release);
+
+    // Host ends the session when the socket closes
+    ring_.reset();
+    if (socket_ >= 0) {
+        ::close(socket_);
+        socket_ = -1;
+    }
+    sessionId_ = -1;
+}
+
+bool GeneratorHostClient::readLine(std::string& line) {
+    line.clear();
+    char c;
+    while (line.size() < 512) {
+        ssize_t n = ::recv(socket_, &c, 1, 0);
+        if (n <= 0) return false;
+        if (c == '\n') return true;
+        line.push_back(c);
+    }
+    return false;
+}
+
+bool GeneratorHostClient::isPeerSameUser() const {
+#if defined(__linux__)
+    ucred credentials = {};
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(socket_, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0) return false;
+    return credentials.uid == getuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(socket_, &uid, &gid) != 0) return false;
+    return uid == getuid();
+#endif
+}
+
+void GeneratorHostClient::checkHealth(short revents) {
+    if (!healthy_.load(std::memory_order_acquire)) return;
+
+    // The host never sends after OPEN, so any readable data or hang-up means it's gone
+    if (revents & (POLLIN | POLLHUP | POLLERR)) {
+        DEBUG_LOG("[GeneratorHostClient] Generator host disconnected, falling back to in-process audio");
+        healthy_.store(false, std::memory_order_release);
+        return;
+    }
+
+    // Stalled = the plugin keeps reading but the host stopped writing. Judged
+    // by frames consumed rather than time, so fallback happens while the ring
+    // still holds audio; an idle (unread) ring is never flagged.
+    uint64_t writePos = ring_->writePosition();
+    uint64_t readPos = ring_->readPosition();
+    if (writePos != lastWritePos_) {
+        lastWritePos_ = writePos;
+        readPosAtLastWrite_ = readPos;
+    } else if (readPos - readPosAtLastWrite_ >= GeneratorHostProtocol::kStallReadFrames) {
+        DEBUG_LOG("[GeneratorHostClient] Generator host stalled, falling back to in-process audio");
+        healthy_.store(false, std::memory_order_release);
+    }
+}
+
+} // namespace Underlay
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "SharedAudioRing.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace Underlay {
+
+class GeneratorHostWatchdog;
+
+/**
+ * Plugin-side connection to the out-of-process generator host.
+ * Owns the control socket and the mapped audio ring for one plugin instance.
+ * connect()/disconnect() are for non-realtime threads; ring() and isHealthy()
+ * are read by process().
+ *
+ * One watchdog thread per process checks every client and marks it unhealthy
+ * when the host hangs up or stops writing while the plugin keeps reading, so
+ * process() falls back to in-process audio before the ring runs dry.
+ */
+class GeneratorHostClient {
+public:
+    GeneratorHostClient() = default;
+    ~GeneratorHostClient();
+
+    // Open a session on the host; returns false (and stays disconnected) on any failure
+    bool connect(const std::string& socketPath, int sampleRate);
+    void disconnect();
+
+    bool isConnected() const { return ring_ != nullptr; }
+    bool isHealthy() const { return healthy_.load(std::memory_order_acquire); }
+    SharedAudioRing* ring() const { return ring_.get(); }
+    int sessionId() const { return sessionId_; }
+
+private:
+    friend class GeneratorHostWatchdog;
+
+    GeneratorHostClient(const GeneratorHostClient&) = delete;
+    GeneratorHostClient& operator=(const GeneratorHostClient&) = delete;
+
+    bool readLine(std::string& line);
+    bool isPeerSameUser() const;
+
+    // Called from the watchdog thread with the socket's poll() result
+    void checkHealth(short revents);
+
+    int socket_ = -1;
+    int sessionId_ = -1;
+    std::unique_ptr<SharedAudioRing> ring_;
+    std::atomic<bool> healthy_{false};
+
+    // Watchdog-thread bookkeeping for stall detection
+    uint64_t lastWritePos_ = 0;
+    uint64_t readPosAtLastWrite_ = 0;
+};
+
+} // namespace Underlay
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+namespace Underlay {
+
+/**
+ * Control plane between plugin instances and the out-of-process generator host.
+ *
+ * One Unix-domain stream connection per plugin instance, newline-terminated text:
+ *   -> OPEN <sampleRate>          <- OK <sessionId> <shmName> <capacityFrames>
+ *   <- ERR <reason>               on any failure
+ * The client unlinks the ring's name once mapped. Closing the connection ends
+ * the session and the host unlinks the ring if the client never mapped it; a
+ * restarted host removes rings left by one that died in between.
+ */
+namespace GeneratorHostProtocol {
+
+static const char* const kSocketName = "underlay-generator-host.sock";
+
+// Ring capacity in frames (~340 ms at 48 kHz) and the fill level the host aims for
+static const unsigned kRingCapacityFrames = 16384;
+static const unsigned kTargetFillFrames = 2048;
+
+// Client treats the host as stalled once it has read this many frames without
+// the host writing any, leaving the rest of the target fill to cover fallback
+static const unsigned kStallReadFrames = kTargetFillFrames / 2;
+
+// Per-user socket path: UNDERLAY_GENERATOR_HOST_SOCKET, else $XDG_RUNTIME_DIR or
+// $TMPDIR (both per-user), else a uid-suffixed name in /tmp
+inline std::string socketPath() {
+    const char* env = std::getenv("UNDERLAY_GENERATOR_HOST_SOCKET");
+    if (env && *env) return env;
+
+    for (const char* var : {"XDG_RUNTIME_DIR", "TMPDIR"}) {
+        const char* dir = std::getenv(var);
+        if (dir && *dir) {
+            std::string path = dir;
+            if (path.back() != '/') path += '/';
+            return path + kSocketName;
+        }
+    }
+    return "/tmp/underlay-generator-host-" + std::to_string(getuid()) + ".sock";
+}
+
+} // namespace GeneratorHostProtocol
+
+} // namespace Underlay
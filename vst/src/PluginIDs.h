@@ -26,6 +26,14 @@ enum ParamID : Steinberg::Vst::ParamID {
     kParamOnlyBassAndDrums = 112,
     kParamPlayPause = 113,
 
+    // Sidechain modulation depths (bipolar, 0.5 = no modulation)
+    kParamSidechainDensityDepth = 114,
+    kParamSidechainBrightnessDepth = 115,
+
+    // Sidechain modulation offsets (read-only outputs, 0.5 = no offset)
+    kParamSidechainDensityMod = 116,
+    kParamSidechainBrightnessMod = 117,
+
     // Layer parameters (50 layers max, 2 params each: weight and enabled)
     kParamLayer1Weight = 200,
     kParamLayer1Enabled = 201,
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "DebugLog.h"
+
+namespace Underlay {
+
+/**
+ * Single-producer/single-consumer stereo audio ring in POSIX shared memory.
+ * The generator host process writes, the plugin's audio thread reads.
+ * Both sides are wait-free: positions are free-running 64-bit counters.
+ */
+class SharedAudioRing {
+public:
+    static constexpr uint32_t kMagic = 0x554C5952;  // "ULYR"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr int kChannels = 2;
+
+    // Producer side: create and size a new segment. Capacity is rounded up to a power of two.
+    static std::unique_ptr<SharedAudioRing> create(const std::string& name, uint32_t capacityFrames, uint32_t sampleRate) {
+        uint32_t capacity = 1;
+        while (capacity < capacityFrames) capacity <<= 1;
+
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            DEBUG_LOG("[SharedAudioRing] shm_open(create) failed for " << name << ": " << strerror(errno));
+            return nullptr;
+        }
+
+        size_t size = segmentSize(capacity);
+        if (ftruncate(fd, (off_t)size) != 0) {
+            DEBUG_LOG("[SharedAudioRing] ftruncate failed for " << name << ": " << strerror(errno));
+            close(fd);
+            shm_unlink(name.c_str());
+            return nullptr;
+        }
+
+        void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) {
+            DEBUG_LOG("[SharedAudioRing] mmap failed for " << name << ": " << strerror(errno));
+            shm_unlink(name.c_str());
+            return nullptr;
+        }
+
+        Header* header = new (mem) Header();
+        header->capacity = capacity;
+        header->sampleRate = sampleRate;
+        header->writePos.store(0, std::memory_order_relaxed);
+        header->readPos.store(0, std::memory_order_relaxed);
+        header->magic = kMagic;
+        header->version = kVersion;
+
+        return std::unique_ptr<SharedAudioRing>(new SharedAudioRing(name, mem, size, true));
+    }
+
+    // Consumer side: map an existing segment created by the host
+    static std::unique_ptr<SharedAudioRing> open(const std::string& name) {
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            DEBUG_LOG("[SharedAudioRing] shm_open failed for " << name << ": " << strerror(errno));
+            return nullptr;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header)) {
+            DEBUG_LOG("[SharedAudioRing] Segment too small: " << name);
+            close(fd);
+            return nullptr;
+        }
+
+        size_t size = (size_t)st.st_size;
+        void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) {
+            DEBUG_LOG("[SharedAudioRing] mmap failed for " << name << ": " << strerror(errno));
+            return nullptr;
+        }
+
+        const Header* header = static_cast<const Header*>(mem);
+        if (header->magic != kMagic || header->version != kVersion ||
+            header->capacity == 0 || (header->capacity & (header->capacity - 1)) != 0 ||
+            segmentSize(header->capacity) > size) {
+            DEBUG_LOG("[SharedAudioRing] Invalid segment header: " << name);
+            munmap(mem, size);
+            return nullptr;
+        }
+
+        return std::unique_ptr<SharedAudioRing>(new SharedAudioRing(name, mem, size, false));
+    }
+
+    ~SharedAudioRing() {
+        munmap(memory_, size_);
+        if (owner_) {
+            // Usually already unlinked by the consumer after mapping
+            shm_unlink(name_.c_str());
+        }
+    }
+
+    // Producer: append up to numFrames, returns frames written (drops the rest when full)
+    size_t write(const float* left, const float* right, size_t numFrames) {
+        uint64_t writePos = header_->writePos.load(std::memory_order_relaxed);
+        uint64_t readPos = header_->readPos.load(std::memory_order_acquire);
+        size_t space = capacity_ - (size_t)(writePos - readPos);
+        size_t frames = std::min(numFrames, space);
+
+        for (size_t i = 0; i < frames; ++i) {
+            size_t idx = (size_t)((writePos + i) & mask_) * kChannels;
+            data_[idx] = left[i];
+            data_[idx + 1] = right ? right[i] : left[i];
+        }
+
+        header_->writePos.store(writePos + frames, std::memory_order_release);
+        return frames;
+    }
+
+    // Consumer (audio thread): fill outputs, zero-padding on underrun. Returns frames read.
+    size_t read(float** outputs, int numChannels, int numSamples) {
+        uint64_t readPos = header_->readPos.load(std::memory_order_relaxed);
+        uint64_t writePos = header_->writePos.load(std::memory_order_acquire);
+        size_t frames = std::min((size_t)numSamples, (size_t)(writePos - readPos));
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            float* out = outputs[ch];
+            int src = std::min(ch, kChannels - 1);
+            for (size_t i = 0; i < frames; ++i) {
+                out[i] = data_[(size_t)((readPos + i) & mask_) * kChannels + src];
+            }
+            if (frames < (size_t)numSamples) {
+                std::memset(out + frames, 0, (numSamples - frames) * sizeof(float));
+            }
+        }
+
+        header_->readPos.store(readPos + frames, std::memory_order_release);
+        return frames;
+    }
+
+    // Frames buffered and not yet read (safe from either side)
+    size_t available() const {
+        uint64_t writePos = header_->writePos.load(std::memory_order_acquire);
+        uint64_t readPos = header_->readPos.load(std::memory_order_acquire);
+        return (size_t)(writePos - readPos);
+    }
+
+    // Total frames ever written; stops advancing if the producer stalls
+    uint64_t writePosition() const {
+        return header_->writePos.load(std::memory_order_acquire);
+    }
+
+    // Total frames ever read
+    uint64_t readPosition() const {
+        return header_->readPos.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return capacity_; }
+    uint32_t sampleRate() const { return header_->sampleRate; }
+    const std::string& name() const { return name_; }
+
+private:
+    // Separate cache lines so producer and consumer don't false-share
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t capacity;
+        uint32_t sampleRate;
+        alignas(64) std::atomic<uint64_t> writePos;
+        alignas(64) std::atomic<uint64_t> readPos;
+        alignas(64) char dataStart[1];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "Shared-memory ring requires lock-free 64-bit atomics");
+
+    static size_t segmentSize(uint32_t capacity) {
+        return offsetof(Header, dataStart) + (size_t)capacity * kChannels * sizeof(float);
+    }
+
+    SharedAudioRing(const std::string& name, void* memory, size_t size, bool owner)
+        : name_(name), memory_(memory), size_(size), owner_(owner) {
+        header_ = static_cast<Header*>(memory);
+        capacity_ = header_->capacity;
+        mask_ = capacity_ - 1;
+        data_ = reinterpret_cast<float*>(header_->dataStart);
+    }
+
+    SharedAudioRing(const SharedAudioRing&) = delete;
+    SharedAudioRing& operator=(const SharedAudioRing&) = delete;
+
+    std::string name_;
+    void* memory_;
+    size_t size_;
+    bool owner_;
+    Header* header_;
+    float* data_;
+    size_t capacity_;
+    uint64_t mask_;
+};
+
+} // namespace Underlay
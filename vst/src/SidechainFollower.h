@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace Underlay {
+
+/**
+ * Control-rate envelope follower and onset detector for the sidechain input.
+ * Runs on the audio thread: no allocation, no locks.
+ *
+ * Input is reduced to one mean-square value every kDecimation samples, and the
+ * envelope/onset state is only advanced at that control rate.
+ */
+class SidechainFollower {
+public:
+    static constexpr int kDecimation = 32;
+
+    void prepare(double sampleRate) {
+        double controlRate = (sampleRate > 0.0 ? sampleRate : 48000.0) / kDecimation;
+        attackCoef_ = coefficient(controlRate, 0.010);
+        releaseCoef_ = coefficient(controlRate, 0.150);
+        fastCoef_ = coefficient(controlRate, 0.005);
+        slowCoef_ = coefficient(controlRate, 0.100);
+        onsetDecayCoef_ = coefficient(controlRate, 0.120);
+        reset();
+    }
+
+    void reset() {
+        sumSquares_ = 0.0f;
+        sampleCount_ = 0;
+        envelope_ = 0.0f;
+        fastLevel_ = 0.0f;
+        slowLevel_ = 0.0f;
+        onset_ = 0.0f;
+        onsetArmed_ = true;
+    }
+
+    // Feed one block of sidechain audio (1 or 2 channels, 32- or 64-bit)
+    template <typename Sample>
+    void process(const Sample* const* channels, int numChannels, int numSamples) {
+        if (!channels || numChannels <= 0 || numSamples <= 0) return;
+        numChannels = std::min(numChannels, 2);
+
+        int pos = 0;
+        while (pos < numSamples) {
+            int chunk = std::min(numSamples - pos, kDecimation - sampleCount_);
+            for (int ch = 0; ch < numChannels; ++ch) {
+                if (channels[ch]) {
+                    sumSquares_ += sumOfSquares(channels[ch] + pos, chunk);
+                }
+            }
+            sampleCount_ += chunk;
+            pos += chunk;
+
+            if (sampleCount_ == kDecimation) {
+                tick(sumSquares_ / (float)(kDecimation * numChannels));
+                sumSquares_ = 0.0f;
+                sampleCount_ = 0;
+            }
+        }
+    }
+
+    // Smoothed level, 0 at -60 dBFS and below, 1 at 0 dBFS
+    float envelope() const { return envelope_; }
+
+    // 1 on a detected transient, decaying back to 0
+    float onset() const { return onset_; }
+
+private:
+    static float coefficient(double controlRate, double seconds) {
+        return (float)std::exp(-1.0 / (controlRate * seconds));
+    }
+
+    // Eight independent accumulators so the compiler can vectorize the
+    // reduction without relaxed floating-point flags.
+    template <typename Sample>
+    static float sumOfSquares(const Sample* x, int n) {
+        Sample lanes[8] = {};
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (int l = 0; l < 8; ++l) {
+                lanes[l] += x[i + l] * x[i + l];
+            }
+        }
+        Sample sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+                     ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        for (; i < n; ++i) {
+            sum += x[i] * x[i];
+        }
+        return (float)sum;
+    }
+
+    // Flush decayed state to zero so silence doesn't run on denormals
+    static float flush(float x) {
+        return std::abs(x) < 1e-6f ? 0.0f : x;
+    }
+
+    void tick(float meanSquare) {
+        // Map -60..0 dBFS to 0..1
+        float db = 10.0f * std::log10(meanSquare + 1e-12f);
+        float level = std::max(0.0f, std::min(1.0f, (db + 60.0f) / 60.0f));
+
+        float coef = level > envelope_ ? attackCoef_ : releaseCoef_;
+        envelope_ = flush(level + coef * (envelope_ - level));
+
+        // Onset: fast level jumps above slow level by more than ~6 dB,
+        // re-armed once it falls back below half that margin
+        fastLevel_ = flush(level + fastCoef_ * (fastLevel_ - level));
+        slowLevel_ = flush(level + slowCoef_ * (slowLevel_ - level));
+        float rise = fastLevel_ - slowLevel_;
+
+        onset_ = flush(onset_ * onsetDecayCoef_);
+        if (onsetArmed_ && rise > kOnsetThreshold) {
+            onset_ = 1.0f;
+            onsetArmed_ = false;
+        } else if (!onsetArmed_ && rise < kOnsetThreshold * 0.5f) {
+            onsetArmed_ = true;
+        }
+    }
+
+    static constexpr float kOnsetThreshold = 0.1f;
+
+    float attackCoef_ = 0.0f;
+    float releaseCoef_ = 0.0f;
+    float fastCoef_ = 0.0f;
+    float slowCoef_ = 0.0f;
+    float onsetDecayCoef_ = 0.0f;
+
+    float sumSquares_ = 0.0f;
+    int sampleCount_ = 0;
+    float envelope_ = 0.0f;
+    float fastLevel_ = 0.0f;
+    float slowLevel_ = 0.0f;
+    float onset_ = 0.0f;
+    bool onsetArmed_ = true;
+};
+
+} // namespace Underlay
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "SidechainFollower.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Underlay {
+
+/**
+ * Turns the sidechain follower output into modulation offsets for Density and
+ * Brightness. Offsets are bipolar (-1..+1) and are added to the user's values
+ * by the UI, so the user's own parameters are never written.
+ *
+ * Sends are rate-limited per target so the controller and WebView only see a
+ * UI-friendly control rate regardless of the host block size.
+ */
+class SidechainModulator {
+public:
+    enum Target { kDensity = 0, kBrightness, kNumTargets };
+
+    // Minimum time between two sends of the same target
+    static constexpr double kMinSendIntervalSeconds = 0.020;
+
+    // Smallest offset change worth sending
+    static constexpr double kMinChange = 1e-3;
+
+    // Keeps the last sent offsets: after re-activation the follower restarts
+    // at zero and the next process() sends the reset to 0
+    void prepare(double sampleRate) {
+        follower_.prepare(sampleRate);
+        minSendInterval_ = (long)((sampleRate > 0.0 ? sampleRate : 48000.0) * kMinSendIntervalSeconds);
+        for (int t = 0; t < kNumTargets; ++t) {
+            samplesSinceSend_[t] = minSendInterval_;
+        }
+    }
+
+    /**
+     * Feed one block. channels may be null when the sidechain bus is off.
+     * Depths are bipolar (-1..+1). send(Target, offset) is called for each
+     * target whose offset changed and whose send interval has elapsed.
+     */
+    template <typename Sample, typename Sink>
+    void process(const Sample* const* channels, int numChannels, int numSamples,
+                 double densityDepth, double brightnessDepth, Sink&& send) {
+        if (channels) {
+            follower_.process(channels, numChannels, numSamples);
+        } else {
+            follower_.reset();
+        }
+
+        double envelope = follower_.envelope();
+        double drive = std::max(envelope, (double)follower_.onset());
+
+        // Density follows level and transients, Brightness follows level
+        double offsets[kNumTargets];
+        offsets[kDensity] = densityDepth * drive;
+        offsets[kBrightness] = brightnessDepth * envelope;
+
+        for (int t = 0; t < kNumTargets; ++t) {
+            samplesSinceSend_[t] += numSamples;
+            double offset = std::max(-1.0, std::min(1.0, offsets[t]));
+            if (std::abs(offset) < kMinChange) offset = 0.0;
+
+            bool changed = std::abs(offset - lastSent_[t]) >= kMinChange ||
+                           (offset == 0.0 && lastSent_[t] != 0.0);
+            if (changed && samplesSinceSend_[t] >= minSendInterval_) {
+                send((Target)t, offset);
+                lastSent_[t] = offset;
+                samplesSinceSend_[t] = 0;
+            }
+        }
+    }
+
+    // Offset <-> normalized parameter value (0.5 = no modulation)
+    static double toNormalized(double offset) { return 0.5 + 0.5 * offset; }
+
+    const SidechainFollower& follower() const { return follower_; }
+
+private:
+    SidechainFollower follower_;
+    long minSendInterval_ = 960;
+    long samplesSinceSend_[kNumTargets] = {};
+    double lastSent_[kNumTargets] = {};
+};
+
+} // namespace Underlay
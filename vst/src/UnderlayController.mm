@@ -349,6 +349,20 @@ Steinberg::tresult PLUGIN_API UnderlayController::initialize(Steinberg::FUnknown
     parameters.addParameter(STR16("Play/Pause"), nullptr, 1, 0,
                            ParameterInfo::kCanAutomate | ParameterInfo::kIsBypass, kParamPlayPause);
 
+    // Sidechain modulation depths (-1..+1, centered = off)
+    parameters.addParameter(STR16("SC Density Depth"), STR16(""), 0, 0.5,
+                           ParameterInfo::kCanAutomate, kParamSidechainDensityDepth);
+
+    parameters.addParameter(STR16("SC Brightness Depth"), STR16(""), 0, 0.5,
+                           ParameterInfo::kCanAutomate, kParamSidechainBrightnessDepth);
+
+    // Sidechain modulation offsets sent by the processor (read-only, centered = none)
+    parameters.addParameter(STR16("SC Density Mod"), STR16(""), 0, 0.5,
+                           ParameterInfo::kIsReadOnly, kParamSidechainDensityMod);
+
+    parameters.addParameter(STR16("SC Brightness Mod"), STR16(""), 0, 0.5,
+                           ParameterInfo::kIsReadOnly, kParamSidechainBrightnessMod);
+
     // Layer parameters (up to 50 layers)
     for (int i = 0; i < 50; ++i) {
         char nameWeight[64], nameEnabled[64];
@@ -1,10 +1,15 @@
 #include "UnderlayVST.h"
 #include "DebugLog.h"
 #include "SharedAudioBuffer.h"
+#if UNDERLAY_EXPERIMENTAL_GENERATOR_HOST
+#include "GeneratorHostProtocol.h"
+#endif
 #include "PluginIDs.h"
 #include "pluginterfaces/vst/ivstparameterchanges.h"
 #include "pluginterfaces/vst/ivstevents.h"
 #include "base/source/fstreamer.h"
+#include <cmath>
+#include <cstdlib>
 
 namespace Underlay {
 
@@ -30,6 +35,10 @@ Steinberg::tresult PLUGIN_API UnderlayProcessor::initialize(Steinberg::FUnknown*
     // Add audio outputs (stereo)
     addAudioOutput(STR16("Stereo Out"), Steinberg::Vst::SpeakerArr::kStereo);
 
+    // Add optional sidechain input (inactive until the host routes audio to it)
+    addAudioInput(STR16("Sidechain In"), Steinberg::Vst::SpeakerArr::kStereo,
+                  Steinberg::Vst::BusTypes::kAux, 0);
+
     // Add MIDI input
     addEventInput(STR16("MIDI In"), 1);
 
@@ -44,8 +53,27 @@ Steinberg::tresult PLUGIN_API UnderlayProcessor::terminate() {
 Steinberg::tresult PLUGIN_API UnderlayProcessor::setActive(Steinberg::TBool state) {
     if (state) {
         DEBUG_LOG("Processor activated");
+        // Last sent offsets survive deactivation; the follower restarts at
+        // zero, so the next process() clears any offset left in the UI
+        sidechainModulator_.prepare(processSetup.sampleRate);
+
+#if UNDERLAY_EXPERIMENTAL_GENERATOR_HOST
+        // Use the generator host if requested and reachable, otherwise fall back to in-process audio
+        const char* useHost = std::getenv("UNDERLAY_GENERATOR_HOST");
+        if (useHost && *useHost && *useHost != '0') {
+            auto client = std::make_unique<GeneratorHostClient>();
+            if (client->connect(GeneratorHostProtocol::socketPath(), (int)processSetup.sampleRate)) {
+                generatorHost_ = std::move(client);
+            } else {
+                DEBUG_LOG("Generator host unavailable, using in-process audio");
+            }
+        }
+#endif
     } else {
         DEBUG_LOG("Processor deactivated");
+#if UNDERLAY_EXPERIMENTAL_GENERATOR_HOST
+        generatorHost_.reset();
+#endif
     }
 
     return AudioEffect::setActive(state);
@@ -82,6 +110,7 @@ Steinberg::tresult PLUGIN_API UnderlayProcessor::process(Steinberg::Vst::Process
 
     updateParameters(data);
     processMidiInput(data);
+    processSidechain(data);
     if (data.numOutputs == 0 || data.outputs[0].numChannels == 0) {
         return Steinberg::kResultOk;
     }
@@ -102,8 +131,18 @@ Steinberg::tresult PLUGIN_API UnderlayProcessor::process(Steinberg::Vst::Process
     }
 
     try {
-        // Pull audio from shared buffer
-        SharedAudioBuffer::getInstance().pullAudio(data.outputs[0].channelBuffers32, numChannels, numSamples);
+        bool pulledFromHost = false;
+#if UNDERLAY_EXPERIMENTAL_GENERATOR_HOST
+        // Wait-free read from the host's ring; falls back once the watchdog flags the host as dead
+        if (generatorHost_ && generatorHost_->isHealthy()) {
+            generatorHost_->ring()->read(data.outputs[0].channelBuffers32, numChannels, numSamples);
+            pulledFromHost = true;
+        }
+#endif
+        if (!pulledFromHost) {
+            // Pull audio from shared buffer
+            SharedAudioBuffer::getInstance().pullAudio(data.outputs[0].channelBuffers32, numChannels, numSamples);
+        }
     } catch (const std::exception& e) {
         DEBUG_LOG("ERROR: Exception in audio processing: " << e.what());
     } catch (...) {
@@ -136,6 +175,45 @@ void UnderlayProcessor::updateParameters(Steinberg::Vst::ProcessData& data) {
     }
 }
 
+double UnderlayProcessor::getParameter(Steinberg::Vst::ParamID id, double defaultValue) const {
+    auto it = parameters_.find(id);
+    return it != parameters_.end() ? it->second : defaultValue;
+}
+
+void UnderlayProcessor::processSidechain(Steinberg::Vst::ProcessData& data) {
+    // Depth parameters are bipolar: 0.5 = off, 0 = full negative, 1 = full positive
+    double densityDepth = getParameter(kParamSidechainDensityDepth, 0.5) * 2.0 - 1.0;
+    double brightnessDepth = getParameter(kParamSidechainBrightnessDepth, 0.5) * 2.0 - 1.0;
+
+    // Offsets go out on the read-only mod parameters; the UI adds them to the
+    // user's Density/Brightness, which are never written from here
+    auto send = [&data](SidechainModulator::Target target, double offset) {
+        if (!data.outputParameterChanges) return;
+        Steinberg::Vst::ParamID id = (target == SidechainModulator::kDensity)
+                                         ? kParamSidechainDensityMod
+                                         : kParamSidechainBrightnessMod;
+        Steinberg::int32 index = 0;
+        Steinberg::Vst::IParamValueQueue* queue =
+            data.outputParameterChanges->addParameterData(id, index);
+        if (queue) {
+            queue->addPoint(0, SidechainModulator::toNormalized(offset), index);
+        }
+    };
+
+    // Sidechain is the only input bus; treated as silent when the host has it switched off
+    bool hasSidechain = data.numInputs > 0 && data.inputs && data.inputs[0].numChannels > 0;
+    int numChannels = hasSidechain ? data.inputs[0].numChannels : 0;
+
+    if (hasSidechain && data.symbolicSampleSize == Steinberg::Vst::kSample64) {
+        sidechainModulator_.process(data.inputs[0].channelBuffers64, numChannels, data.numSamples,
+                                    densityDepth, brightnessDepth, send);
+    } else {
+        sidechainModulator_.process(hasSidechain ? data.inputs[0].channelBuffers32 : nullptr,
+                                    numChannels, data.numSamples,
+                                    densityDepth, brightnessDepth, send);
+    }
+}
+
 void UnderlayProcessor::processMidiInput(Steinberg::Vst::ProcessData& data) {
     if (!data.inputEvents) return;
 
@@ -155,7 +233,14 @@ Steinberg::tresult PLUGIN_API UnderlayProcessor::setBusArrangements(
     Steinberg::Vst::SpeakerArrangement* outputs,
     Steinberg::int32 numOuts) {
 
-    if (numOuts == 1 && outputs[0] == Steinberg::Vst::SpeakerArr::kStereo) {
+    if (numOuts != 1 || outputs[0] != Steinberg::Vst::SpeakerArr::kStereo) {
+        return Steinberg::kResultFalse;
+    }
+
+    // Sidechain input is optional; accept stereo or mono
+    if (numIns == 0 ||
+        (numIns == 1 && (inputs[0] == Steinberg::Vst::SpeakerArr::kStereo ||
+                         inputs[0] == Steinberg::Vst::SpeakerArr::kMono))) {
         return AudioEffect::setBusArrangements(inputs, numIns, outputs, numOuts);
     }
 
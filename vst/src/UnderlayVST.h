@@ -2,7 +2,12 @@
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
 #include "PluginIDs.h"
+#include "SidechainModulator.h"
+#if UNDERLAY_EXPERIMENTAL_GENERATOR_HOST
+#include "GeneratorHostClient.h"
+#endif
 #include <map>
+#include <memory>
 #include <vector>
 #include <mutex>
 
@@ -54,6 +59,18 @@ private:
     // Update parameters from automation
     void updateParameters(Steinberg::Vst::ProcessData& data);
 
+    // Run the sidechain follower and send modulation offsets to the controller
+    void processSidechain(Steinberg::Vst::ProcessData& data);
+    double getParameter(Steinberg::Vst::ParamID id, double defaultValue) const;
+
+    // Sidechain analysis state
+    SidechainModulator sidechainModulator_;
+
+#if UNDERLAY_EXPERIMENTAL_GENERATOR_HOST
+    // Test-only out-of-process generator (UNDERLAY_GENERATOR_HOST=1); null when in-process
+    std::unique_ptr<GeneratorHostClient> generatorHost_;
+#endif
+
     // Audio buffer for routing from WKWebView
     std::vector<std::vector<float>> audioBuffer_;
     std::mutex audioBufferMutex_;